@@ -0,0 +1,225 @@
+/**********************************************************************
+ * Streaming detection of clustered (hyper-)editing sites
+ *
+ * Goals:
+ *  - Group coordinate sorted candidate sites, separately for each
+ *    tissue, into clusters of sites no more than a set distance apart
+ *  - Label each site with its cluster ID as it is printed, holding
+ *    back only the sites whose cluster membership is still unknown
+ *  - Provide a class to be used by editTools::edit_search()
+ *
+ **********************************************************************/
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+#include <deque>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+
+class ClusterScan
+{
+
+  /**************************************************
+   * A cluster is a run of sites within a tissue on one
+   *  chromosome where each site is at most max_dist bases
+   *  from the previous, containing at least min_sites sites.
+   *
+   * Site - an output line waiting to be printed.
+   *  cluster is -1 while unknown, 0 if the site is not
+   *  clustered, otherwise the cluster ID
+   * Chain - the open run of sites for one tissue.
+   *  pending holds sequence numbers of sites printed
+   *  before the run reached min_sites
+   **************************************************/
+
+  struct Site
+  {
+    std::string line;
+    std::string tissue;
+    long cluster;
+  };
+
+  struct Chain
+  {
+    std::string chrom;
+    unsigned long start;
+    unsigned long end;
+    int n;
+    long id;
+    std::map< std::string, int > comp;
+    std::vector< unsigned long > pending;
+
+    Chain() : start(0), end(0), n(0), id(0) {}
+  };
+
+  unsigned long max_dist;
+  int min_sites;
+  char strand;
+  long n_clusters;
+
+  // Sites in output order, front_seq is the sequence number
+  //  of the first one
+  std::deque< Site > queue;
+  unsigned long front_seq;
+  std::map< std::string, Chain > chains;
+
+  // Reported clusters
+  std::vector< long > c_id;
+  std::vector< std::string > c_chrom;
+  std::vector< unsigned long > c_start;
+  std::vector< unsigned long > c_end;
+  std::vector< std::string > c_tissue;
+  std::vector< int > c_sites;
+  std::vector< std::string > c_comp;
+
+
+  // Ends the open run for a tissue. Reports it if it became a cluster,
+  //  otherwise its held back sites are released as unclustered
+  void close(const std::string& tissue, Chain& c)
+  {
+    if (c.id > 0) {
+      std::ostringstream comp;
+      for (std::map< std::string, int >::const_iterator it = c.comp.begin(); it != c.comp.end(); it++) {
+        if (it != c.comp.begin())
+          comp << ';';
+        comp << it->first << '=' << it->second;
+      }
+
+      c_id.push_back(c.id);
+      c_chrom.push_back(c.chrom);
+      c_start.push_back(c.start);
+      c_end.push_back(c.end);
+      c_tissue.push_back(tissue);
+      c_sites.push_back(c.n);
+      c_comp.push_back(comp.str());
+    } else {
+      for (size_t i = 0; i < c.pending.size(); i++)
+        queue[c.pending[i] - front_seq].cluster = 0;
+    }
+
+    c.n = 0;
+    c.id = 0;
+    c.comp.clear();
+    c.pending.clear();
+  }
+
+  // Prints sites from the front of the queue until one is reached whose
+  //  run could still grow into a cluster at chrom:pos
+  void flush(const std::string& chrom, unsigned long pos)
+  {
+    while (!queue.empty()) {
+      Site& s = queue.front();
+
+      if (s.cluster < 0) {
+        Chain& c = chains[s.tissue];
+        if (c.chrom == chrom && pos <= c.end + max_dist)
+          break;
+        close(s.tissue, c);
+      }
+
+      Rcout << s.line << '\t';
+      if (s.cluster > 0)
+        Rcout << strand << s.cluster;
+      else
+        Rcout << "NA";
+      Rcout << std::endl;
+
+      queue.pop_front();
+      front_seq++;
+    }
+  }
+
+
+public:
+  ClusterScan(unsigned long max_dist, int min_sites, char strand)
+  {
+    this->max_dist = max_dist;
+    this->min_sites = min_sites;
+    this->strand = strand;
+    this->n_clusters = 0;
+    this->front_seq = 0;
+  }
+
+
+  // Add a site passing all filters. Sites must arrive sorted by
+  //  position within each chromosome
+  void add(const std::string& chrom,
+           unsigned long pos,
+           const std::string& tissue,
+           const std::string& mismatch,
+           const std::string& line)
+  {
+    Chain& c = chains[tissue];
+
+    // Break the run on a new chromosome, a gap that is too wide or
+    //  out of order input
+    if (c.n > 0 && (c.chrom != chrom || pos < c.end || pos > c.end + max_dist))
+      close(tissue, c);
+
+    if (c.n == 0) {
+      c.chrom = chrom;
+      c.start = pos;
+      c.id = 0;
+    }
+    c.end = pos;
+    c.n++;
+    c.comp[mismatch]++;
+
+    Site s = {line, tissue, c.id > 0 ? c.id : -1};
+    queue.push_back(s);
+
+    // Once a run is long enough it becomes a cluster, and all of its
+    //  held back sites can be labeled
+    if (c.id == 0) {
+      c.pending.push_back(front_seq + queue.size() - 1);
+      if (c.n >= min_sites) {
+        c.id = ++n_clusters;
+        for (size_t i = 0; i < c.pending.size(); i++)
+          queue[c.pending[i] - front_seq].cluster = c.id;
+        c.pending.clear();
+      }
+    }
+
+    flush(chrom, pos);
+  }
+
+
+  // Close every open run and print the remaining sites
+  void finish()
+  {
+    for (std::map< std::string, Chain >::iterator it = chains.begin(); it != chains.end(); it++) {
+      if (it->second.n > 0)
+        close(it->first, it->second);
+    }
+    flush("", 0);
+  }
+
+
+  // Reported clusters as a data.frame
+  DataFrame clusters()
+  {
+    CharacterVector id(c_id.size());
+    CharacterVector str(c_id.size());
+    for (size_t i = 0; i < c_id.size(); i++) {
+      std::ostringstream os;
+      os << strand << c_id[i];
+      id[i] = os.str();
+      str[i] = std::string(1, strand);
+    }
+
+    return DataFrame::create(Named("Cluster") = id,
+                             Named("Chr") = c_chrom,
+                             Named("Start") = NumericVector(c_start.begin(), c_start.end()),
+                             Named("End") = NumericVector(c_end.begin(), c_end.end()),
+                             Named("Strand") = str,
+                             Named("Tissue") = c_tissue,
+                             Named("Sites") = c_sites,
+                             Named("Composition") = c_comp,
+                             Named("stringsAsFactors") = false);
+  }
+};
@@ -5,10 +5,43 @@
 
 using namespace Rcpp;
 
+// count_events
+List count_events(IntegerVector tissue, CharacterVector tissue_levels, IntegerVector event, CharacterVector event_levels, LogicalVector keep, std::string event_name, bool wname, int trim);
+RcppExport SEXP _editTools_count_events(SEXP tissueSEXP, SEXP tissue_levelsSEXP, SEXP eventSEXP, SEXP event_levelsSEXP, SEXP keepSEXP, SEXP event_nameSEXP, SEXP wnameSEXP, SEXP trimSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type tissue(tissueSEXP);
+    Rcpp::traits::input_parameter< CharacterVector >::type tissue_levels(tissue_levelsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type event(eventSEXP);
+    Rcpp::traits::input_parameter< CharacterVector >::type event_levels(event_levelsSEXP);
+    Rcpp::traits::input_parameter< LogicalVector >::type keep(keepSEXP);
+    Rcpp::traits::input_parameter< std::string >::type event_name(event_nameSEXP);
+    Rcpp::traits::input_parameter< bool >::type wname(wnameSEXP);
+    Rcpp::traits::input_parameter< int >::type trim(trimSEXP);
+    rcpp_result_gen = Rcpp::wrap(count_events(tissue, tissue_levels, event, event_levels, keep, event_name, wname, trim));
+    return rcpp_result_gen;
+END_RCPP
+}
+// edit_frac_hist
+DataFrame edit_frac_hist(IntegerVector group, int n_group, NumericVector frac, NumericVector breaks);
+RcppExport SEXP _editTools_edit_frac_hist(SEXP groupSEXP, SEXP n_groupSEXP, SEXP fracSEXP, SEXP breaksSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type group(groupSEXP);
+    Rcpp::traits::input_parameter< int >::type n_group(n_groupSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type frac(fracSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type breaks(breaksSEXP);
+    rcpp_result_gen = Rcpp::wrap(edit_frac_hist(group, n_group, frac, breaks));
+    return rcpp_result_gen;
+END_RCPP
+}
 // edit_search
-void edit_search(std::string file, char strand, CharacterVector names, bool ex_indel, int geno_dp, int geno_hom, int edit_dp, int bias);
-RcppExport SEXP _editTools_edit_search(SEXP fileSEXP, SEXP strandSEXP, SEXP namesSEXP, SEXP ex_indelSEXP, SEXP geno_dpSEXP, SEXP geno_homSEXP, SEXP edit_dpSEXP, SEXP biasSEXP) {
+DataFrame edit_search(std::string file, char strand, CharacterVector names, bool ex_indel, int geno_dp, int geno_hom, int edit_dp, int bias, int cluster_dist, int cluster_min);
+RcppExport SEXP _editTools_edit_search(SEXP fileSEXP, SEXP strandSEXP, SEXP namesSEXP, SEXP ex_indelSEXP, SEXP geno_dpSEXP, SEXP geno_homSEXP, SEXP edit_dpSEXP, SEXP biasSEXP, SEXP cluster_distSEXP, SEXP cluster_minSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
     Rcpp::traits::input_parameter< char >::type strand(strandSEXP);
@@ -18,8 +51,10 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< int >::type geno_hom(geno_homSEXP);
     Rcpp::traits::input_parameter< int >::type edit_dp(edit_dpSEXP);
     Rcpp::traits::input_parameter< int >::type bias(biasSEXP);
-    edit_search(file, strand, names, ex_indel, geno_dp, geno_hom, edit_dp, bias);
-    return R_NilValue;
+    Rcpp::traits::input_parameter< int >::type cluster_dist(cluster_distSEXP);
+    Rcpp::traits::input_parameter< int >::type cluster_min(cluster_minSEXP);
+    rcpp_result_gen = Rcpp::wrap(edit_search(file, strand, names, ex_indel, geno_dp, geno_hom, edit_dp, bias, cluster_dist, cluster_min));
+    return rcpp_result_gen;
 END_RCPP
 }
 // mbym_search
@@ -44,7 +79,9 @@ END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
-    {"_editTools_edit_search", (DL_FUNC) &_editTools_edit_search, 8},
+    {"_editTools_count_events", (DL_FUNC) &_editTools_count_events, 8},
+    {"_editTools_edit_frac_hist", (DL_FUNC) &_editTools_edit_frac_hist, 4},
+    {"_editTools_edit_search", (DL_FUNC) &_editTools_edit_search, 10},
     {"_editTools_mbym_search", (DL_FUNC) &_editTools_mbym_search, 11},
     {NULL, NULL, 0}
 };
@@ -15,6 +15,8 @@ using namespace Rcpp;
 
 #include <fstream>
 
+#include "Cluster.h"
+
 /**********************************************************
  * Global parse_v() - Used to split vcf lines into vectors
  *  Overloaded (2 flavors)
@@ -92,6 +94,12 @@ public:
     
     this->tissue_name = tissue_name;
   }
+  
+  // If the sample meets every criteria for editing
+  bool is_edit() const
+  {
+    return (depth_flag && diff_flag && sb_flag);
+  }
 };
 
 
@@ -299,7 +307,7 @@ public:
   bool contains_edit()
   {
     for (std::list<Rna>::iterator it = rna_list.begin(); it != rna_list.end(); it++) {
-      if (it->depth_flag && it->diff_flag && it->sb_flag)
+      if (it->is_edit())
         return true;
     }
     return false;
@@ -361,19 +369,27 @@ public:
   }
   
 
-  // Variant objects send certain members and method results to stdout
-  //  Can be used with cout or Rcout. Output intended to be redirected.
-  friend std::ostream& operator<<(std::ostream& os, Variant& var)
+  // Writes a single edited Rna sample as a tab delimited line, without
+  //  a trailing newline
+  void write_site(std::ostream& os, const Rna& r)
+  {
+    os << chrom << '\t' << pos << '\t' << strand <<
+      '\t' <<  call << "to" << r.call << '\t' << dna_dp << '\t' << dna_dv << '\t' <<
+        r.rna_dp << '\t' << r.edit_dp << '\t' << r.edit_frac << '\t' << r.sb << '\t' <<
+          ave_mq << '\t' << r.tissue_name;
+  }
+  
+  // Hands each edited Rna sample to a ClusterScan, which prints it
+  //  once its cluster membership is known
+  void scan_clusters(ClusterScan& scan)
   {
-    for (std::list<Rna>::iterator it = var.rna_list.begin(); it != var.rna_list.end(); it++) {
-      if (it->depth_flag && it->diff_flag && it->sb_flag)
-        os << var.chrom << '\t' << var.pos << '\t' << var.strand <<
-          '\t' <<  var.call << "to" << it->call << '\t' << var.dna_dp << '\t' << var.dna_dv << '\t' <<
-            it->rna_dp << '\t' << it->edit_dp << '\t' << it->edit_frac << '\t' << it->sb << '\t' <<
-              var.ave_mq << '\t' << it->tissue_name << std::endl;
+    for (std::list<Rna>::iterator it = rna_list.begin(); it != rna_list.end(); it++) {
+      if (it->is_edit()) {
+        std::ostringstream line;
+        write_site(line, *it);
+        scan.add(chrom, pos, it->tissue_name, call + "to" + it->call, line.str());
+      }
     }
-    
-    return os;
   }
 };
 
@@ -0,0 +1,288 @@
+/**********************************************************************
+ * Aggregation kernels for edit_table summaries
+ *
+ * Goals:
+ *  - Provide a single pass group-by over integer coded tissue and
+ *    event keys, used by count_mismatch() and the plotting tools
+ *  - Bin mismatch fractions for edit_prop_plot() into bins defined
+ *    in R, without handing every site to ggplot2
+ *
+ * Keys are coded in R with factor() so that level order (and
+ *  therefore tie breaking) matches table().
+ **********************************************************************/
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+
+// Orders event codes within a tissue. Most common on top, ties
+//  left in level order, as order(decreasing = TRUE) does in R
+struct FreqDesc
+{
+  const std::vector< int >& freq;
+  FreqDesc(const std::vector< int >& f) : freq(f) {}
+  bool operator()(int a, int b) const { return freq[a] > freq[b]; }
+};
+
+
+// Orders tissue codes from fewest to most events
+struct TotalAsc
+{
+  const std::vector< int >& total;
+  TotalAsc(const std::vector< int >& t) : total(t) {}
+  bool operator()(int a, int b) const { return total[a] < total[b]; }
+};
+
+
+// Assemble a single tissue summary as a data.frame with columns
+//  <event>, Freq, [Tissue], Prop
+List event_frame(const std::vector< std::string >& ev,
+                 const std::vector< int >& freq,
+                 const std::vector< double >& prop,
+                 const std::vector< std::string >& rnames,
+                 const std::string& event,
+                 const std::string& tissue,
+                 bool wname)
+{
+  int n = ev.size();
+  CharacterVector ev_col(ev.begin(), ev.end());
+  IntegerVector freq_col(freq.begin(), freq.end());
+  NumericVector prop_col(prop.begin(), prop.end());
+  CharacterVector rn(rnames.begin(), rnames.end());
+
+  List tab;
+  CharacterVector cols;
+
+  if (wname) {
+    CharacterVector tiss_col(n);
+    for (int i = 0; i < n; i++)
+      tiss_col[i] = tissue;
+    tab = List::create(ev_col, freq_col, tiss_col, prop_col);
+    cols = CharacterVector::create(event, "Freq", "Tissue", "Prop");
+  } else {
+    tab = List::create(ev_col, freq_col, prop_col);
+    cols = CharacterVector::create(event, "Freq", "Prop");
+  }
+
+  tab.attr("names") = cols;
+  tab.attr("row.names") = rn;
+  tab.attr("class") = "data.frame";
+  return tab;
+}
+
+
+// Row name rbind() gives a row appended to a table with row names
+//  rnames: its position, made unique against the existing names the way
+//  make.unique(sep = "") does
+std::string other_rowname(const std::vector< std::string >& rnames)
+{
+  std::string pos = std::to_string(rnames.size() + 1);
+  std::string name = pos;
+  for (int i = 1; std::find(rnames.begin(), rnames.end(), name) != rnames.end(); i++)
+    name = pos + std::to_string(i);
+  return name;
+}
+
+
+// Counts events for each tissue. Returns the list of data.frames
+//  built by count_mismatch(), one per tissue, ordered from the tissue
+//  with the fewest events to the most.
+//
+// tissue, event - 1-based factor codes (NA codes are skipped)
+// keep - rows to consider when counting events (NA treated as FALSE).
+//  Tissue order is always determined from every row.
+// trim - maximum number of events to keep, NA for no trimming
+// [[Rcpp::export]]
+List count_events(IntegerVector tissue,
+                  CharacterVector tissue_levels,
+                  IntegerVector event,
+                  CharacterVector event_levels,
+                  LogicalVector keep,
+                  std::string event_name,
+                  bool wname,
+                  int trim)
+{
+  int n = tissue.size();
+  int n_tiss = tissue_levels.size();
+  int n_event = event_levels.size();
+
+  // Single pass - total events in each tissue and a dense
+  //  tissue x event count of kept rows
+  std::vector< int > total(n_tiss, 0);
+  std::vector< int > cnt(n_tiss * n_event, 0);
+  for (int i = 0; i < n; i++) {
+    if (tissue[i] == NA_INTEGER)
+      continue;
+    total[tissue[i] - 1]++;
+    if (keep[i] == TRUE && event[i] != NA_INTEGER)
+      cnt[(tissue[i] - 1) * n_event + event[i] - 1]++;
+  }
+
+  // Tissues that appear at all, from fewest to most events
+  std::vector< int > tiss;
+  for (int t = 0; t < n_tiss; t++) {
+    if (total[t] > 0)
+      tiss.push_back(t);
+  }
+  std::stable_sort(tiss.begin(), tiss.end(), TotalAsc(total));
+
+  // Order each tissue's events: level order first (as table() reports),
+  //  then most common on top
+  std::vector< std::vector< int > > tiss_events(tiss.size());
+  std::vector< std::vector< int > > tiss_freq(tiss.size());
+  std::vector< std::vector< int > > tiss_rank(tiss.size());
+  std::vector< int > tiss_sum(tiss.size(), 0);
+
+  for (size_t k = 0; k < tiss.size(); k++) {
+    std::vector< int > freq(cnt.begin() + tiss[k] * n_event,
+                            cnt.begin() + (tiss[k] + 1) * n_event);
+
+    // Position of each event within table() gives its row name
+    std::vector< int > seen, rank(n_event, 0);
+    for (int e = 0; e < n_event; e++) {
+      if (freq[e] > 0) {
+        rank[e] = seen.size();
+        seen.push_back(e);
+      }
+    }
+    std::stable_sort(seen.begin(), seen.end(), FreqDesc(freq));
+
+    for (size_t r = 0; r < seen.size(); r++) {
+      tiss_freq[k].push_back(freq[seen[r]]);
+      tiss_rank[k].push_back(rank[seen[r]]);
+      tiss_sum[k] += freq[seen[r]];
+    }
+    tiss_events[k] = seen;
+  }
+
+  // Check if trim is supplied and actually needed
+  bool do_trim = false;
+  std::vector< char > common(n_event, 0);
+  if (trim != NA_INTEGER) {
+    for (size_t k = 0; k < tiss.size(); k++) {
+      if (trim < (int) tiss_events[k].size())
+        do_trim = true;
+    }
+  }
+
+  // Top trim events (in order of the first tissue) shared by every tissue
+  if (do_trim) {
+    std::vector< int > present(n_event, 0);
+    for (size_t k = 0; k < tiss.size(); k++) {
+      for (size_t r = 0; r < tiss_events[k].size(); r++)
+        present[tiss_events[k][r]]++;
+    }
+    int n_common = 0;
+    for (size_t r = 0; r < tiss_events[0].size() && n_common < trim; r++) {
+      int e = tiss_events[0][r];
+      if (present[e] == (int) tiss.size()) {
+        common[e] = 1;
+        n_common++;
+      }
+    }
+  }
+
+  // Build a data.frame for each tissue
+  List mismatch_table(tiss.size());
+  CharacterVector tiss_names(tiss.size());
+
+  for (size_t k = 0; k < tiss.size(); k++) {
+    std::string tname = std::string(tissue_levels[tiss[k]]);
+    std::vector< std::string > ev, rnames;
+    std::vector< int > fr;
+    std::vector< double > prop;
+    int other_freq = 0;
+
+    for (size_t r = 0; r < tiss_events[k].size(); r++) {
+      int e = tiss_events[k][r];
+      if (do_trim && !common[e]) {
+        other_freq += tiss_freq[k][r];
+        continue;
+      }
+      ev.push_back(std::string(event_levels[e]));
+      fr.push_back(tiss_freq[k][r]);
+      prop.push_back((double) tiss_freq[k][r] / tiss_sum[k]);
+      rnames.push_back(std::to_string(tiss_rank[k][r] + 1));
+    }
+
+    // Events outside the common set are stored in an "other" category
+    if (do_trim) {
+      ev.push_back("other");
+      fr.push_back(other_freq);
+      prop.push_back((double) other_freq / tiss_sum[k]);
+      rnames.push_back(other_rowname(rnames));
+    }
+
+    mismatch_table[k] = event_frame(ev, fr, prop, rnames, event_name, tname, wname);
+    tiss_names[k] = tname;
+  }
+
+  mismatch_table.attr("names") = tiss_names;
+  return mismatch_table;
+}
+
+
+// Bins mismatch fractions for each group into the bins defined by
+//  breaks (sorted). Bins are right closed, the lowest break is included
+//  in the first bin and values outside the breaks are skipped. An empty
+//  bin is padded to either end so that lines drop to zero.
+//
+// group - 1-based factor codes (NA codes and non-finite frac are skipped)
+// Returns a data.frame with columns Group (code), Center and Count
+// [[Rcpp::export]]
+DataFrame edit_frac_hist(IntegerVector group,
+                         int n_group,
+                         NumericVector frac,
+                         NumericVector breaks)
+{
+  int n = frac.size();
+  int n_bins = breaks.size() - 1;
+
+  if (n_bins < 1)
+    return DataFrame::create(Named("Group") = IntegerVector(0),
+                             Named("Center") = NumericVector(0),
+                             Named("Count") = IntegerVector(0));
+
+  // Slot 0 and n_bins + 1 are the padding bins
+  int slots = n_bins + 2;
+  std::vector< int > counts(slots * n_group, 0);
+
+  for (int i = 0; i < n; i++) {
+    if (group[i] == NA_INTEGER || !R_FINITE(frac[i]))
+      continue;
+
+    // First break not below the value closes its bin
+    int b = std::lower_bound(breaks.begin(), breaks.end(), frac[i]) - breaks.begin();
+    if (b == 0 && frac[i] == breaks[0])
+      b = 1;
+    if (b < 1 || b > n_bins)
+      continue;
+    counts[(group[i] - 1) * slots + b]++;
+  }
+
+  // Bin centers, with padding bins as wide as their neighbours
+  std::vector< double > mid(slots);
+  for (int s = 1; s <= n_bins; s++)
+    mid[s] = (breaks[s - 1] + breaks[s]) / 2;
+  mid[0] = mid[1] - (breaks[1] - breaks[0]);
+  mid[slots - 1] = mid[n_bins] + (breaks[n_bins] - breaks[n_bins - 1]);
+
+  IntegerVector grp(slots * n_group);
+  NumericVector center(slots * n_group);
+  IntegerVector count(counts.begin(), counts.end());
+  for (int g = 0; g < n_group; g++) {
+    for (int s = 0; s < slots; s++) {
+      grp[g * slots + s] = g + 1;
+      center[g * slots + s] = mid[s];
+    }
+  }
+
+  return DataFrame::create(Named("Group") = grp,
+                           Named("Center") = center,
+                           Named("Count") = count);
+}
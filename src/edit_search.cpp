@@ -4,19 +4,26 @@
 //' @useDynLib editTools
 //' @importFrom Rcpp sourceCpp
 // [[Rcpp::export]]
-void edit_search(std::string file,
-                char strand,
-                CharacterVector names,
-                bool ex_indel,
-                int geno_dp,
-                int geno_hom,
-                int edit_dp,
-                int bias)
+DataFrame edit_search(std::string file,
+                      char strand,
+                      CharacterVector names,
+                      bool ex_indel,
+                      int geno_dp,
+                      int geno_hom,
+                      int edit_dp,
+                      int bias,
+                      int cluster_dist,
+                      int cluster_min)
 {
   
   std::string line;
   std::ifstream vcf1(file);
   std::vector< std::string > header;
+  
+  // Sites passing all filters are streamed through a per tissue
+  //  window to label clustered (hyper-)editing sites. cluster_dist and
+  //  cluster_min are validated by find_edits()
+  ClusterScan scan((unsigned long) cluster_dist, cluster_min, strand);
 
   
   std::vector< std::string > names_vec(names.size());
@@ -68,7 +75,7 @@ void edit_search(std::string file,
     // Var.likelihood_filter(lh);
     
     // If Variant passes all filters, call genotypes for each sample
-    //  and print
+    //  and print once cluster membership is known
     if (Var.indel_filter() &&
         // Var.qual_filter(qual) &&
         Var.gt_filter(genos) &&
@@ -77,8 +84,11 @@ void edit_search(std::string file,
         Var.contains_edit()) {
       
       Var.call_samples();
-      Rcout << Var;
+      Var.scan_clusters(scan);
 
     }
   }
+  
+  scan.finish();
+  return scan.clusters();
 }